@@ -0,0 +1,7 @@
+//go:build sqlean_alloc_stats
+// +build sqlean_alloc_stats
+
+package sqlean
+
+// #cgo CFLAGS: -DSQLEAN_ALLOC_STATS
+import "C"
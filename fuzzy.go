@@ -0,0 +1,13 @@
+//go:build !sqlean_omit_fuzzy
+// +build !sqlean_omit_fuzzy
+
+package sqlean
+
+// #cgo CFLAGS: -DSQLEAN_ENABLE_FUZZY
+//
+// #include "sqlean.h"
+import "C"
+
+func init() {
+	register("fuzzy", func(c DatabaseConnection) error { return ret(C.fuzzy_init((*C.struct_sqlite3)(c))) })
+}
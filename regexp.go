@@ -0,0 +1,13 @@
+//go:build !sqlean_omit_regexp
+// +build !sqlean_omit_regexp
+
+package sqlean
+
+// #cgo CFLAGS: -DSQLEAN_ENABLE_REGEXP
+//
+// #include "sqlean.h"
+import "C"
+
+func init() {
+	register("regexp", func(c DatabaseConnection) error { return ret(C.regexp_init((*C.struct_sqlite3)(c))) })
+}
@@ -422,6 +422,74 @@ int define_init(sqlite3* db);
 #endif /* DEFINE_EXTENSION_H */
 
 #endif // SQLEAN_ENABLE_DEFINE
+#ifdef SQLEAN_ENABLE_REGEXP
+// ---------------------------------
+// regexp/extension.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// Regular expressions for SQLite.
+
+#ifndef REGEXP_EXTENSION_H
+#define REGEXP_EXTENSION_H
+
+
+int regexp_init(sqlite3* db);
+
+#endif /* REGEXP_EXTENSION_H */
+
+// ---------------------------------
+// regexp/matches.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// regexp_matches table-valued function.
+
+#ifndef REGEXP_MATCHES_H
+#define REGEXP_MATCHES_H
+
+
+int regexp_matches_init(sqlite3* db);
+
+#endif /* REGEXP_MATCHES_H */
+
+// ---------------------------------
+// regexp/regexp.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// Linear-time regular expression engine.
+
+#ifndef REGEXP_H
+#define REGEXP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Regexp is a compiled regular expression. It owns the DFA cache and the
+// scratch space used for matching, so it must not be shared between threads.
+typedef struct Regexp Regexp;
+
+// RegexpScan is the state of a search for all the matches in a text.
+typedef struct {
+    size_t pos;    // where the next search starts
+    int prev_end;  // end of the previous match, or -1
+} RegexpScan;
+
+Regexp* regexp_compile(const char* pattern, size_t length, const char** error);
+void regexp_free(void* re);
+int regexp_groups(const Regexp* re);
+bool regexp_is_match(Regexp* re, const char* str, size_t length);
+bool regexp_find(Regexp* re, const char* str, size_t length, size_t start, int* caps);
+RegexpScan regexp_scan(void);
+bool regexp_find_next(Regexp* re, const char* str, size_t length, RegexpScan* scan, int* caps);
+
+#endif /* REGEXP_H */
+
+#endif // SQLEAN_ENABLE_REGEXP
 #ifdef SQLEAN_ENABLE_STATS
 // ---------------------------------
 // src/stats/extension.h
@@ -457,6 +525,70 @@ int stats_series_init(sqlite3* db);
 #endif /* STATS_INTERNAL_H */
 
 #endif // SQLEAN_ENABLE_STATS
+#if defined(SQLEAN_ENABLE_TEXT) || defined(SQLEAN_ENABLE_FUZZY)
+// ---------------------------------
+// text/arena.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// Scratch memory for the temporaries of a text function call.
+// Shared with the fuzzy extension, like the rune decoder.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// number of bytes an arena serves from its own buffer on the stack
+#define ARENA_INLINE_SIZE 512
+// the scratch block does not grow larger than this, bigger temporaries come from the heap
+#define ARENA_BLOCK_MAX_SIZE (1 << 20)
+
+// ArenaBlock is a scratch block shared by the text function calls of a connection.
+typedef struct {
+    char* bytes;
+    size_t size;
+    // indicates whether an arena is using the block
+    bool busy;
+    // number of functions that hold the block as their user data, plus the one registering them
+    int refs;
+} ArenaBlock;
+
+// Arena hands out memory for the temporaries of a single function call:
+// from its inline buffer first, then from the connection's scratch block,
+// and only then from the heap. All the memory is released at once.
+typedef struct {
+    union {
+        char bytes[ARENA_INLINE_SIZE];
+        uint64_t align;
+    };
+    size_t used;
+    ArenaBlock* block;
+    size_t block_used;
+    // number of bytes that did not fit into the block
+    size_t overflow;
+    // heap allocations, freed with the arena
+    struct ArenaChunk* chunks;
+} Arena;
+
+ArenaBlock* arena_block_new(void);
+void arena_block_release(void* block);
+int arena_create_function(sqlite3* db,
+                          const char* name,
+                          int n_arg,
+                          int flags,
+                          ArenaBlock* block,
+                          void (*func)(sqlite3_context*, int, sqlite3_value**));
+void arena_init(Arena* arena, ArenaBlock* block);
+void* arena_alloc(Arena* arena, size_t size);
+void arena_release(Arena* arena);
+
+#endif /* ARENA_H */
+
+#endif // SQLEAN_ENABLE_TEXT || SQLEAN_ENABLE_FUZZY
 #ifdef SQLEAN_ENABLE_TEXT
 // ---------------------------------
 // src/text/bstring.h
@@ -464,6 +596,9 @@ int stats_series_init(sqlite3* db);
 // Copyright (c) 2023 Anton Zhiyanov, MIT License
 // https://github.com/nalgeon/sqlean
 
+// Modified in sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
 // Byte string data structure.
 
 #ifndef BSTRING_H
@@ -480,10 +615,54 @@ typedef struct {
     // number of bytes in the string
     size_t length;
     // indicates whether the string owns the array
-    // and should free the memory when destroyed
+    // and should free the memory when destroyed;
+    // slices, trimmed strings and split parts do not own their bytes,
+    // they point into the original string and are not zero-terminated
     bool owning;
 } ByteString;
 
+// ByteSearcher is a substring prepared for repeated searches.
+typedef struct {
+    // the substring to search for
+    ByteString needle;
+    // indicates whether the two-way tables below are computed,
+    // they are only needed for adversarial inputs and are filled on demand
+    bool prepared;
+    // critical factorization of the needle: start of the right part, its period
+    // and the length of the prefix known to match after a shift by the period
+    size_t suffix;
+    size_t period;
+    size_t memory;
+    // distance from the last occurrence of each byte to the end of the needle
+    size_t shift[256];
+} ByteSearcher;
+
+// ByteAutomaton is a set of substrings prepared for searching all of them at once
+// (an Aho-Corasick automaton).
+typedef struct {
+    // number of bytes in each substring
+    size_t* lengths;
+    // number of bytes in the longest substring
+    size_t max_length;
+    // indicates whether one of the substrings is empty
+    bool has_empty;
+    // indicates whether the automaton matches the reversed substrings,
+    // to scan the string backwards
+    bool reversed;
+    // searchers for each substring (NULL for the empty ones) when the transition table
+    // would be too large, the substrings are then searched one by one and `next` is NULL
+    ByteSearcher** searchers;
+    // bytes that occur in the substrings are mapped to classes 1..n_classes-1,
+    // all the other bytes to class 0
+    uint16_t classes[256];
+    size_t n_classes;
+    // transitions between the states: next[state * n_classes + class]
+    int32_t* next;
+    // the longest substring that ends in each state, or -1
+    int32_t* match;
+    size_t n_states;
+} ByteAutomaton;
+
 // ByteString methods.
 struct bstring_ns {
     ByteString (*new)(void);
@@ -503,6 +682,21 @@ struct bstring_ns {
     bool (*has_suffix)(ByteString str, ByteString other);
     size_t (*count)(ByteString str, ByteString other);
 
+    ByteSearcher* (*searcher)(ByteString needle);
+    void (*free_searcher)(ByteSearcher* searcher);
+    int (*search)(ByteSearcher* searcher, ByteString str, size_t start);
+    size_t (*search_count)(ByteSearcher* searcher, ByteString str);
+    ByteString (*search_replace)(ByteSearcher* searcher,
+                                 ByteString str,
+                                 ByteString new,
+                                 size_t max_count);
+
+    ByteAutomaton* (*automaton)(const ByteString* needles, size_t count, bool reversed);
+    void (*free_automaton)(ByteAutomaton* ac);
+    bool (*contains_any)(ByteAutomaton* ac, ByteString str);
+    int (*find_any)(ByteAutomaton* ac, ByteString str, size_t start, size_t* needle);
+    ByteString (*replace_many)(ByteAutomaton* ac, ByteString str, const ByteString* replacements);
+
     ByteString (*split_part)(ByteString str, ByteString sep, size_t part);
     ByteString (*join)(ByteString* strings, size_t count, ByteString sep);
     ByteString (*concat)(ByteString* strings, size_t count);
@@ -545,6 +739,9 @@ int text_init(sqlite3* db);
 // Copyright (c) 2023 Anton Zhiyanov, MIT License
 // https://github.com/nalgeon/sqlean
 
+// Modified in sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
 // Rune (UTF-8) string data structure.
 
 #ifndef RSTRING_H
@@ -570,8 +767,8 @@ typedef struct {
 // RuneString methods.
 struct rstring_ns {
     RuneString (*new)(void);
-    RuneString (*from_cstring)(const char* const utf8str);
-    char* (*to_cstring)(RuneString str);
+    RuneString (*from_cstring)(Arena* arena, const char* const utf8str);
+    char* (*to_cstring)(Arena* arena, RuneString str);
     void (*free)(RuneString str);
 
     int32_t (*at)(RuneString str, size_t idx);
@@ -581,14 +778,14 @@ struct rstring_ns {
     int (*index)(RuneString str, RuneString other);
     int (*last_index)(RuneString str, RuneString other);
 
-    RuneString (*translate)(RuneString str, RuneString from, RuneString to);
+    RuneString (*translate)(Arena* arena, RuneString str, RuneString from, RuneString to);
     RuneString (*reverse)(RuneString str);
 
     RuneString (*trim_left)(RuneString str, RuneString chars);
     RuneString (*trim_right)(RuneString str, RuneString chars);
     RuneString (*trim)(RuneString str, RuneString chars);
-    RuneString (*pad_left)(RuneString str, size_t length, RuneString fill);
-    RuneString (*pad_right)(RuneString str, size_t length, RuneString fill);
+    RuneString (*pad_left)(Arena* arena, RuneString str, size_t length, RuneString fill);
+    RuneString (*pad_right)(Arena* arena, RuneString str, size_t length, RuneString fill);
 
     void (*print)(RuneString str);
 };
@@ -597,12 +794,17 @@ extern struct rstring_ns rstring;
 
 #endif /* RSTRING_H */
 
+#endif // SQLEAN_ENABLE_TEXT
+#if defined(SQLEAN_ENABLE_TEXT) || defined(SQLEAN_ENABLE_FUZZY)
 // ---------------------------------
 // src/text/runes.h
 // ---------------------------------
 // Copyright (c) 2023 Anton Zhiyanov, MIT License
 // https://github.com/nalgeon/sqlean
 
+// Modified in sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
 // UTF-8 characters (runes) <-> C string conversions.
 
 #ifndef RUNES_H
@@ -611,12 +813,112 @@ extern struct rstring_ns rstring;
 #include <stdint.h>
 #include <stdlib.h>
 
-int32_t* runes_from_cstring(const char* const str, size_t length);
-char* runes_to_cstring(const int32_t* runes, size_t length);
+size_t utf8_length(const char* str, size_t size);
+size_t utf8_offset(const char* str, size_t size, size_t idx);
+size_t utf8_offset_back(const char* str, size_t size, size_t count);
+int32_t* runes_from_cstring(Arena* arena, const char* const str, size_t length);
+char* runes_to_cstring(Arena* arena, const int32_t* runes, size_t length);
 
 #endif /* RUNES_H */
 
+#endif // SQLEAN_ENABLE_TEXT || SQLEAN_ENABLE_FUZZY
+#ifdef SQLEAN_ENABLE_TEXT
+// ---------------------------------
+// text/split.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// text_split_each table-valued function.
+
+#ifndef TEXT_SPLIT_H
+#define TEXT_SPLIT_H
+
+
+int text_split_init(sqlite3* db);
+
+#endif /* TEXT_SPLIT_H */
+
 #endif // SQLEAN_ENABLE_TEXT
+#ifdef SQLEAN_ENABLE_FUZZY
+// ---------------------------------
+// fuzzy/extension.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// Fuzzy string matching for SQLite.
+
+#ifndef FUZZY_EXTENSION_H
+#define FUZZY_EXTENSION_H
+
+
+int fuzzy_init(sqlite3* db);
+
+#endif /* FUZZY_EXTENSION_H */
+
+// ---------------------------------
+// fuzzy/fuzzy.h
+// ---------------------------------
+// Part of sqlean.go, MIT License
+// https://github.com/riyaz-ali/sqlean.go
+
+// Fuzzy string matching.
+
+#ifndef FUZZY_H
+#define FUZZY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// size of the alphabet of ascii strings, their characters index the tables as is
+#define FUZZY_ASCII_SIZE 128
+
+// FuzzyPair is a pair of strings decoded into characters (runes),
+// which the distance functions may trim, swap and renumber.
+typedef struct {
+    int32_t* a;
+    size_t a_len;
+    int32_t* b;
+    size_t b_len;
+    // indicates whether both strings are ascii
+    bool ascii;
+} FuzzyPair;
+
+// FuzzyPattern holds the bit vectors of a pattern string: for every character,
+// the bits are set at the positions where the character occurs in the pattern.
+typedef struct {
+    // `rows` rows of `words` words each, followed by a zero row
+    // shared by the characters missing from the pattern
+    uint64_t* bits;
+    size_t rows;
+    size_t words;
+} FuzzyPattern;
+
+bool fuzzy_pair_init(FuzzyPair* pair,
+                     Arena* arena,
+                     const char* a,
+                     size_t a_size,
+                     const char* b,
+                     size_t b_size);
+void fuzzy_pair_swap(FuzzyPair* pair);
+void fuzzy_pair_trim(FuzzyPair* pair);
+size_t fuzzy_pair_symbols(FuzzyPair* pair, Arena* arena, bool pattern_a, bool distinct);
+bool fuzzy_pattern_init(FuzzyPattern* pattern,
+                        Arena* arena,
+                        const int32_t* str,
+                        size_t length,
+                        size_t rows);
+
+int64_t fuzzy_levenshtein(FuzzyPair* pair, Arena* arena, int64_t max);
+int64_t fuzzy_osa_distance(FuzzyPair* pair, Arena* arena);
+int64_t fuzzy_damerau_levenshtein(FuzzyPair* pair, Arena* arena);
+double fuzzy_jaro_winkler(FuzzyPair* pair, Arena* arena);
+
+#endif /* FUZZY_H */
+
+#endif // SQLEAN_ENABLE_FUZZY
 #ifdef SQLEAN_ENABLE_UNICODE
 // ---------------------------------
 // src/unicode/extension.h
@@ -1,10 +1,15 @@
 package sqlean_test
 
 import (
+	"bytes"
+	"crypto/sha1"
+	"crypto/sha256"
 	"database/sql"
+	"fmt"
 	"github.com/mattn/go-sqlite3"
 	"github.com/riyaz-ali/sqlean.go"
 	"reflect"
+	"strings"
 	"testing"
 )
 
@@ -17,7 +22,7 @@ func init() {
 	})
 }
 
-func Open(t *testing.T, url string) (db *sql.DB) {
+func Open(t testing.TB, url string) (db *sql.DB) {
 	var err error
 	if db, err = sql.Open("sqlean", url); err != nil {
 		t.Fatalf("failed to open connection: %v", err)
@@ -25,6 +30,32 @@ func Open(t *testing.T, url string) (db *sql.DB) {
 	return db
 }
 
+// QueryRows runs the query and returns its rows, with every column scanned as a string.
+func QueryRows(t *testing.T, db *sql.DB, query string) (result [][]string) {
+	var rows, err = db.Query(query)
+	if err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	defer rows.Close()
+
+	var columns, _ = rows.Columns()
+	for rows.Next() {
+		var row = make([]string, len(columns))
+		var dest = make([]interface{}, len(columns))
+		for i := range row {
+			dest[i] = &row[i]
+		}
+		if err = rows.Scan(dest...); err != nil {
+			t.Fatalf("scan failed: %v", err)
+		}
+		result = append(result, row)
+	}
+	if err = rows.Err(); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	return result
+}
+
 func TestSqleanCrypto_sha256(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -37,6 +68,55 @@ func TestSqleanCrypto_sha256(t *testing.T) {
 	t.Logf("sha256(%q) => %s", "Hello World", hash)
 }
 
+// compares the digests with the Go implementations on inputs around the block boundaries
+func TestSqleanCrypto_digests(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var data = make([]byte, 100000)
+	for i := range data {
+		data[i] = byte(i*7 + 3)
+	}
+	for _, n := range []int{1, 55, 56, 63, 64, 65, 119, 128, 129, 1000, 100000} {
+		var sha1Hash, sha256Hash []byte
+		if err := db.QueryRow("SELECT sha1(?1), sha256(?1)", data[:n]).Scan(&sha1Hash, &sha256Hash); err != nil {
+			t.Fatalf("query failed: %v", err)
+		}
+		if want := sha1.Sum(data[:n]); !bytes.Equal(sha1Hash, want[:]) {
+			t.Errorf("sha1(%d bytes) => %x, want %x", n, sha1Hash, want)
+		}
+		if want := sha256.Sum256(data[:n]); !bytes.Equal(sha256Hash, want[:]) {
+			t.Errorf("sha256(%d bytes) => %x, want %x", n, sha256Hash, want)
+		}
+	}
+}
+
+// hashes blobs of different sizes, reports the throughput
+func BenchmarkSqleanCrypto_hash(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	var data = make([]byte, 16<<20)
+	for i := range data {
+		data[i] = byte(i * 7)
+	}
+	for _, algo := range []string{"sha1", "sha256"} {
+		for _, size := range []int{64, 1 << 10, 64 << 10, 1 << 20, 16 << 20} {
+			b.Run(fmt.Sprintf("%s/%d", algo, size), func(b *testing.B) {
+				var query = fmt.Sprintf("SELECT %s(?)", algo)
+				var hash []byte
+				b.SetBytes(int64(size))
+				for i := 0; i < b.N; i++ {
+					if err := db.QueryRow(query, data[:size]).Scan(&hash); err != nil {
+						b.Fatalf("query failed: %v", err)
+					}
+				}
+			})
+		}
+	}
+}
+
 func TestSqleanDefine_plusone(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -93,6 +173,66 @@ func TestSqleanFileIO_ls(t *testing.T) {
 	}
 }
 
+func TestSqleanFuzzy_distances(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	const query = `SELECT levenshtein('kitten', 'sitting'), dlevenshtein('ca', 'abc'),
+		osa_distance('ca', 'abc'), levenshtein('привет', 'привод')`
+	var leven, damlev, osa, unicode int
+	if err := db.QueryRow(query).Scan(&leven, &damlev, &osa, &unicode); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if leven != 3 || damlev != 2 || osa != 3 || unicode != 2 {
+		t.Errorf("distances => %d %d %d %d", leven, damlev, osa, unicode)
+	}
+}
+
+func TestSqleanFuzzy_editDistanceLe(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var within, beyond bool
+	const query = `SELECT edit_distance_le('kitten', 'sitting', 3), edit_distance_le('kitten', 'sitting', 2)`
+	if err := db.QueryRow(query).Scan(&within, &beyond); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if !within || beyond {
+		t.Errorf("edit_distance_le() => %v %v", within, beyond)
+	}
+}
+
+func TestSqleanFuzzy_jaroWinkler(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var similarity float64
+	if err := db.QueryRow("SELECT round(jaro_winkler('martha', 'marhta'), 4)").Scan(&similarity); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if similarity != 0.9611 {
+		t.Errorf("jaro_winkler() => %f", similarity)
+	}
+}
+
+// invalid utf-8 bytes count as one character each, like in the text functions
+func TestSqleanFuzzy_invalidUtf8(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var rows = QueryRows(t, db, `SELECT
+		levenshtein(cast(x'ff' AS text), cast(x'fe' AS text)), levenshtein(cast(x'80' AS text), 'a'),
+		dlevenshtein(cast(x'ff' AS text), cast(x'fe' AS text)), dlevenshtein(cast(x'ff61fe' AS text), cast(x'fe61ff' AS text)),
+		osa_distance(cast(x'ff' AS text), cast(x'fe' AS text)), osa_distance(cast(x'80' AS text), 'a'),
+		edit_distance_le(cast(x'ff' AS text), cast(x'fe' AS text), 0), edit_distance_le(cast(x'ff61' AS text), cast(x'fe61' AS text), 1),
+		jaro_winkler(cast(x'ff' AS text), cast(x'fe' AS text)), jaro_winkler(cast(x'ff' AS text), cast(x'ff' AS text))`)
+
+	var expected = [][]string{{"1", "1", "1", "2", "1", "1", "0", "1", "0", "1"}}
+	if !reflect.DeepEqual(rows, expected) {
+		t.Errorf("fuzzy functions on invalid utf-8 => %v", rows)
+	}
+}
+
 func TestSqleanIpAddr_ipnetwork(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -117,6 +257,73 @@ func TestSqleanMath_sqrt(t *testing.T) {
 	t.Logf("sqrt(%d) => %d", 9, root)
 }
 
+func TestSqleanRegexp_like(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var like, op bool
+	const query = `SELECT regexp_like('the year 2023', '\d{4}$'), 'abc' REGEXP '^a.c$'`
+	if err := db.QueryRow(query).Scan(&like, &op); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if !like || !op {
+		t.Errorf("regexp_like() => %v, REGEXP => %v", like, op)
+	}
+
+	if err := db.QueryRow("SELECT regexp_like('abc', '(a')").Scan(&like); err == nil {
+		t.Errorf("expected invalid pattern error")
+	}
+
+	// invalid bytes and encoded surrogates are not characters
+	var invalid, surrogate, valid bool
+	const dots = `SELECT regexp_like(x'ff', '^.$'), regexp_like(x'eda080', '^.$'), regexp_like(x'ee8080', '^.$')`
+	if err := db.QueryRow(dots).Scan(&invalid, &surrogate, &valid); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if invalid || surrogate || !valid {
+		t.Errorf("regexp_like(., x'ff') => %v, x'eda080' => %v, x'ee8080' => %v", invalid, surrogate, valid)
+	}
+}
+
+func TestSqleanRegexp_substr(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var sub string
+	if err := db.QueryRow(`SELECT regexp_substr('ship 123 at 45', '\d+')`).Scan(&sub); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if sub != "123" {
+		t.Errorf("regexp_substr() => %q", sub)
+	}
+}
+
+func TestSqleanRegexp_replace(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var replaced string
+	const query = `SELECT regexp_replace('2023-12-31', '(\d+)-(\d+)-(\d+)', '$3.${2}.$1 ($$)')`
+	if err := db.QueryRow(query).Scan(&replaced); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if replaced != "31.12.2023 ($)" {
+		t.Errorf("regexp_replace() => %q", replaced)
+	}
+}
+
+func TestSqleanRegexp_matches(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var matches = QueryRows(t, db, `SELECT idx, value, offset, groups FROM regexp_matches('кот=1, пёс=22', '([^=, ]+)=(\d+)')`)
+
+	var expected = [][]string{{"1", "кот=1", "1", `["кот","1"]`}, {"2", "пёс=22", "8", `["пёс","22"]`}}
+	if !reflect.DeepEqual(matches, expected) {
+		t.Errorf("regexp_matches() => %v", matches)
+	}
+}
+
 func TestSqleanStats_median(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -143,6 +350,318 @@ func TestSqleanText_substr(t *testing.T) {
 	t.Logf("text_substring(%s, %d) => %s", "Hello World", 7, substr)
 }
 
+func TestSqleanText_left(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var left, right, slice string
+	if err := db.QueryRow("SELECT text_left(?1, 3), text_right(?1, 2), text_slice(?1, -3, -1)", "Привет, мир").Scan(&left, &right, &slice); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if left != "При" || right != "ир" || slice != "ми" {
+		t.Errorf("text_left() => %s, text_right() => %s, text_slice() => %s", left, right, slice)
+	}
+}
+
+func TestSqleanText_count(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var count int
+	var replaced string
+	if err := db.QueryRow("SELECT text_count(?1, ?2), text_replace(?1, ?2, 'x')", "aaaaabaaaab", "aaaab").Scan(&count, &replaced); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if count != 2 || replaced != "axx" {
+		t.Errorf("text_count() => %d, text_replace() => %s", count, replaced)
+	}
+}
+
+func TestSqleanText_index(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	// the needle is the same for every row, so it is prepared only once
+	var sum int
+	if err := db.QueryRow("SELECT sum(text_index('Привет, мир ' || value, 'мир')) FROM generate_series(1, 10)").Scan(&sum); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if sum != 90 {
+		t.Errorf("sum(text_index()) => %d", sum)
+	}
+}
+
+func TestSqleanText_replaceMany(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var found, index int
+	var replaced string
+	const query = `SELECT
+		text_contains_any('the cat sat on the mat', 'dog', 'mat'),
+		text_find_any('Привет, мир', 'мир', 'вет'),
+		text_replace_many('the cat sat on the mat', 'cat', 'dog', 'mat', 'rug', 'the', 'a', 'a', 'the')`
+	if err := db.QueryRow(query).Scan(&found, &index, &replaced); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if found != 1 || index != 4 || replaced != "a dog sthet on a rug" {
+		t.Errorf("text_contains_any() => %d, text_find_any() => %d, text_replace_many() => %q", found, index, replaced)
+	}
+
+	// the long substring almost matches at every position, but only matches at the end
+	var src = strings.Repeat("a", 10000) + "x"
+	var long = strings.Repeat("a", 2000) + "x"
+	if err := db.QueryRow("SELECT text_replace_many(?, 'a', 'b', ?, 'c')", src, long).Scan(&replaced); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+	if replaced != strings.Repeat("b", 8000)+"c" {
+		t.Errorf("text_replace_many() => %d bytes", len(replaced))
+	}
+}
+
+func TestSqleanText_pad(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var left, right, cut, trimmed string
+	const query = `SELECT text_lpad('мир', 8, 'ab€'), text_rpad('мир', 7, '–'), text_lpad('привет', 3), text_trim('--мир__', '_-')`
+	if err := db.QueryRow(query).Scan(&left, &right, &cut, &trimmed); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if left != "ab€abмир" || right != "мир––––" || cut != "при" || trimmed != "мир" {
+		t.Errorf("text_lpad() => %q, text_rpad() => %q, %q, text_trim() => %q", left, right, cut, trimmed)
+	}
+
+	// the string ends at the first zero byte
+	var zero, leading string
+	const zeros = `SELECT text_lpad(cast(x'6100622063' AS text), 6, '*'), text_lpad(cast(x'00616263' AS text), 6, '*')`
+	if err := db.QueryRow(zeros).Scan(&zero, &leading); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+	if zero != "*****a" || leading != "******" {
+		t.Errorf("text_lpad() => %q, %q", zero, leading)
+	}
+}
+
+func TestSqleanText_zeroBytes(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	// results that end at the end of the argument keep the zero bytes inside them
+	var part, trimmed string
+	if err := db.QueryRow("SELECT hex(text_split(?1, ',', 2)), hex(text_ltrim(?1, 'c,'))", "c,a\x00b").Scan(&part, &trimmed); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if part != "610062" || trimmed != "610062" {
+		t.Errorf("text_split() => %s, text_ltrim() => %s", part, trimmed)
+	}
+}
+
+func TestSqleanText_translate(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	// the mapping is the same for every row, so it is prepared only once
+	var phones, mixed string
+	const query = `SELECT
+		group_concat(text_translate('+1 (555) 01' || value, '+() ', ''), ','),
+		text_translate('Ärger über 42', 'Äü4e', 'Au€')
+		FROM generate_series(1, 3)`
+	if err := db.QueryRow(query).Scan(&phones, &mixed); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if phones != "1555011,1555012,1555013" || mixed != "Argr ubr €2" {
+		t.Errorf("text_translate() => %q, %q", phones, mixed)
+	}
+
+	// an invalid byte is a character of its own, and a stray continuation byte is part of the one before it
+	var emoji, continuation string
+	const invalid = `SELECT
+		hex(text_translate(cast(replace(hex(zeroblob(1500)), '0', x'ff') AS text), cast(x'ff' AS text), '😀')) =
+			replace(hex(zeroblob(1500)), '0', 'F09F9880'),
+		hex(text_translate(cast(x'61808182' AS text), cast(x'80' AS text), 'x'))`
+	if err := db.QueryRow(invalid).Scan(&emoji, &continuation); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if emoji != "1" || continuation != "61808182" {
+		t.Errorf("text_translate() on invalid utf-8 => %s, %s", emoji, continuation)
+	}
+}
+
+func TestSqleanText_splitEach(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var parts = QueryRows(t, db, "SELECT idx, value, offset FROM text_split_each('один,два,,три', ',')")
+
+	var expected = [][]string{{"1", "один", "1"}, {"2", "два", "6"}, {"3", "", "10"}, {"4", "три", "11"}}
+	if !reflect.DeepEqual(parts, expected) {
+		t.Errorf("text_split_each() => %v", parts)
+	}
+}
+
+// checks how many heap allocations the text functions make per call,
+// needs the text_alloc_count function from the sqlean_alloc_stats build
+func TestSqleanText_allocs(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var count = func() (n int64) {
+		if err := db.QueryRow("SELECT text_alloc_count()").Scan(&n); err != nil {
+			t.Skipf("text_alloc_count is not available: %v", err)
+		}
+		return n
+	}
+	count()
+
+	var cases = []struct {
+		expr   string
+		allocs int64
+	}{
+		{"text_substring(s, 3, 5)", 0},
+		{"text_trim(s, '-')", 0},
+		{"text_split(s, ',', 2)", 0},
+		{"text_replace(s, ',', ';')", 1},
+		{"text_replace(s, 'none', ';')", 0},
+		{"text_repeat(s, 3)", 1},
+		{"text_lpad(s, 40, '*')", 0},
+		{"text_rpad(s, 5)", 0},
+		{"text_translate(s, 'од', 'OD')", 0},
+		{"text_translate(s, 'xyz', 'XYZ')", 0},
+		{"text_reverse(s)", 0},
+		{"text_join(',', s, s)", 1},
+		{"text_concat(s, 42, NULL, s)", 1},
+		{"text_last_index(s, ',')", 0},
+	}
+
+	const rows = 100
+	for _, c := range cases {
+		var before = count()
+		var query = "SELECT count(" + c.expr + ") FROM (SELECT '--один,два,три--' || value AS s FROM generate_series(1, ?))"
+		if _, err := db.Exec(query, rows); err != nil {
+			t.Fatalf("query failed: %v", err)
+		}
+		if allocs := (count() - before) / rows; allocs > c.allocs {
+			t.Errorf("%s => %d allocations per call, want %d", c.expr, allocs, c.allocs)
+		}
+	}
+}
+
+// measures substring search with a plain needle and with needles that
+// match the haystack almost everywhere
+func BenchmarkSqleanText_contains(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	const populate = `CREATE TABLE t AS SELECT
+		printf('%.*c', 16384, 'a') AS repeated,
+		replace(printf('%.*c', 8192, 'x'), 'x', 'ab') AS periodic,
+		replace(printf('%.*c', 300, 'x'), 'x', 'The quick brown fox jumps over the lazy dog. ') AS english
+		FROM generate_series(1, 100)`
+	if _, err := db.Exec(populate); err != nil {
+		b.Fatalf("failed to populate table: %v", err)
+	}
+
+	var run = func(column, needle string) func(b *testing.B) {
+		return func(b *testing.B) {
+			var query = "SELECT count(*) FROM t WHERE text_contains(" + column + ", ?)"
+			for i := 0; i < b.N; i++ {
+				var count int
+				if err := db.QueryRow(query, needle).Scan(&count); err != nil {
+					b.Fatalf("query failed: %v", err)
+				}
+			}
+		}
+	}
+
+	b.ResetTimer()
+	b.Run("english", run("english", "lazy cat"))
+	b.Run("repeated", run("repeated", strings.Repeat("a", 255)+"b"))
+	b.Run("periodic", run("periodic", strings.Repeat("ab", 128)+"b"))
+}
+
+// compares keyword classification with chained text_contains calls
+// against a single text_contains_any call
+func BenchmarkSqleanText_containsAny(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	const populate = `CREATE TABLE t AS SELECT
+		'order ' || value || ' shipped to the warehouse on monday, ticket ' || (value * 7919 % 1000) AS text
+		FROM generate_series(1, 10000)`
+	if _, err := db.Exec(populate); err != nil {
+		b.Fatalf("failed to populate table: %v", err)
+	}
+
+	var keywords []string
+	for i := 0; i < 40; i++ {
+		keywords = append(keywords, fmt.Sprintf("'keyword%d'", i))
+	}
+
+	var run = func(query string) func(b *testing.B) {
+		return func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				var count int
+				if err := db.QueryRow(query).Scan(&count); err != nil {
+					b.Fatalf("query failed: %v", err)
+				}
+			}
+		}
+	}
+
+	b.ResetTimer()
+	b.Run("chained", run("SELECT count(*) FROM t WHERE text_contains(text, "+
+		strings.Join(keywords, ") OR text_contains(text, ")+")"))
+	b.Run("automaton", run("SELECT count(*) FROM t WHERE text_contains_any(text, "+
+		strings.Join(keywords, ", ")+")"))
+}
+
+// measures the rune-based text functions over corpora of 1, 2, 3 and 4 byte characters
+func BenchmarkSqleanText_runes(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	var corpora = []struct{ name, text string }{
+		{"ascii", "The quick brown fox jumps over the lazy dog. "},
+		{"cyrillic", "Съешь же ещё этих мягких французских булок, да выпей чаю. "},
+		{"cjk", "我能吞下玻璃而不伤身体。敏捷的棕色狐狸跳过了懒狗。"},
+		{"emoji", "😀😃😄😁😆😅🤣😂🙂🙃😉😊😇🥰😍🤩"},
+	}
+
+	if _, err := db.Exec("CREATE TABLE corpus(name TEXT, text TEXT)"); err != nil {
+		b.Fatalf("failed to create table: %v", err)
+	}
+	for _, corpus := range corpora {
+		const populate = "INSERT INTO corpus SELECT ?1, value || ' ' || replace(printf('%.*c', 20, 'x'), 'x', ?2) FROM generate_series(1, 1000)"
+		if _, err := db.Exec(populate, corpus.name, corpus.text); err != nil {
+			b.Fatalf("failed to populate table: %v", err)
+		}
+	}
+
+	b.ResetTimer()
+	for _, corpus := range corpora {
+		b.Run(corpus.name, func(b *testing.B) {
+			const query = "SELECT sum(text_length(text) + length(text_substring(text, 100, 200)) + text_index(text, 'z')) FROM corpus WHERE name = ?"
+			for i := 0; i < b.N; i++ {
+				var sum int
+				if err := db.QueryRow(query, corpus.name).Scan(&sum); err != nil {
+					b.Fatalf("query failed: %v", err)
+				}
+			}
+		})
+	}
+}
+
 func TestSqleanUnicode_unaccent(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -155,6 +674,257 @@ func TestSqleanUnicode_unaccent(t *testing.T) {
 	t.Logf("unaccent(%s) => %s", "hôtel", str)
 }
 
+func TestSqleanUnicode_unchanged(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	// the first two arguments are returned as is, the last one grows when decomposed
+	var same, folded, grown string
+	if err := db.QueryRow("SELECT unaccent(?), casefold(?), unaccent(?)", "12 Main Street", "rue de l'église", "Æsir Œuvre").Scan(&same, &folded, &grown); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if same != "12 Main Street" || folded != "rue de l'église" || grown != "AEsir OEuvre" {
+		t.Errorf("unaccent() => %s, casefold() => %s, unaccent() => %s", same, folded, grown)
+	}
+}
+
+func TestSqleanUnicode_lower(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var lower string
+	var like bool
+	if err := db.QueryRow("SELECT lower(?), ? LIKE ?", "ПРИВЕТ Мир", "Crème Brûlée", "%BRULEE").Scan(&lower, &like); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if lower != "привет мир" || !like {
+		t.Errorf("lower() => %s, like => %v", lower, like)
+	}
+
+	t.Logf("lower(%s) => %s", "ПРИВЕТ Мир", lower)
+}
+
+func TestSqleanUnicode_upper(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	// deseret and adlam letters live outside of the basic multilingual plane
+	var upper string
+	var equal bool
+	if err := db.QueryRow("SELECT upper(?), ? = ? COLLATE NOCASE", "𐐨𐐩 𞤢 😀", "𐐨𐐩", "𐐀𐐁").Scan(&upper, &equal); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if upper != "𐐀𐐁 𞤀 😀" || !equal {
+		t.Errorf("upper() => %s, nocase => %v", upper, equal)
+	}
+
+	t.Logf("upper(%s) => %s", "𐐨𐐩 𞤢 😀", upper)
+}
+
+func TestSqleanUnicode_like(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var tests = []struct {
+		value, pattern string
+		want           bool
+	}{
+		{"Привет Мир", "привет%", true},
+		{"Привет Мир", "%МИР", true},
+		{"Привет Мир", "%ВЕТ М%", true},
+		{"Привет Мир", "%в_т%м_р", true},
+		{"Привет Мир", "мир%", false},
+		{"100% sure", `100\% %`, true},
+		{"1000 sure", `100\% %`, false},
+	}
+
+	for _, test := range tests {
+		var like bool
+		if err := db.QueryRow(`SELECT ? LIKE ? ESCAPE '\'`, test.value, test.pattern).Scan(&like); err != nil {
+			t.Errorf("query failed: %v", err)
+		}
+
+		if like != test.want {
+			t.Errorf("%q LIKE %q => %v, want %v", test.value, test.pattern, like, test.want)
+		}
+	}
+}
+
+func TestSqleanUnicode_sortkey(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	db.SetMaxOpenConns(1)
+
+	for _, query := range []string{
+		"CREATE TABLE t(name TEXT)",
+		"INSERT INTO t VALUES ('été'), ('Ete'), ('eta'), ('ÉTÉ!'), ('Ж'), ('ж'), ('zebra'), ('Zèbre'), (''), ('e')",
+		"CREATE INDEX t_name ON t(unicode_sortkey(name))",
+	} {
+		if _, err := db.Exec(query); err != nil {
+			t.Fatalf("failed to populate table: %v", err)
+		}
+	}
+
+	var order = func(query string) (names []string) {
+		rows, err := db.Query(query)
+		if err != nil {
+			t.Fatalf("query failed: %v", err)
+		}
+		defer rows.Close()
+
+		for rows.Next() {
+			var name string
+			if err = rows.Scan(&name); err != nil {
+				t.Errorf("rows.Scan(): %v", err)
+			}
+			names = append(names, name)
+		}
+		return names
+	}
+
+	var nocase = order("SELECT name FROM t ORDER BY name COLLATE NOCASE")
+	var sortkey = order("SELECT name FROM t ORDER BY unicode_sortkey(name)")
+	if !reflect.DeepEqual(nocase, sortkey) {
+		t.Errorf("ORDER BY unicode_sortkey() => %q, want %q", sortkey, nocase)
+	}
+
+	t.Logf("ORDER BY unicode_sortkey() => %q", sortkey)
+}
+
+// SkipWithoutFts5 skips the test if the sqlite library is built without fts5.
+func SkipWithoutFts5(t testing.TB, db *sql.DB) {
+	if _, err := db.Exec("CREATE VIRTUAL TABLE temp.fts5_probe USING fts5(a)"); err != nil {
+		t.Skipf("fts5 is not available (build with -tags sqlite_fts5): %v", err)
+	}
+	if _, err := db.Exec("DROP TABLE temp.fts5_probe"); err != nil {
+		t.Fatalf("failed to drop table: %v", err)
+	}
+}
+
+func TestSqleanUnicode_tokenizer(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+	SkipWithoutFts5(t, db)
+
+	for _, query := range []string{
+		"CREATE VIRTUAL TABLE words USING fts5(name, tokenize = 'sqlean_unicode')",
+		"CREATE VIRTUAL TABLE trigrams USING fts5(name, tokenize = 'sqlean_unicode trigram')",
+		"INSERT INTO words VALUES ('Crème Brûlée'), ('Café au lait')",
+		"INSERT INTO trigrams VALUES ('Crème Brûlée'), ('Café au lait')",
+	} {
+		if _, err := db.Exec(query); err != nil {
+			t.Fatalf("failed to populate tables: %v", err)
+		}
+	}
+
+	for _, tt := range []struct {
+		table, match, want string
+	}{
+		{"words", "BRULEE", "Crème Brûlée"},
+		{"words", "cafe", "Café au lait"},
+		{"trigrams", `"RULEE"`, "Crème Brûlée"},
+		{"trigrams", `"fe au"`, "Café au lait"},
+	} {
+		var name string
+		var query = fmt.Sprintf("SELECT name FROM %s WHERE %s MATCH ?", tt.table, tt.table)
+		if err := db.QueryRow(query, tt.match).Scan(&name); err != nil {
+			t.Errorf("%s MATCH '%s' failed: %v", tt.table, tt.match, err)
+			continue
+		}
+
+		if name != tt.want {
+			t.Errorf("%s MATCH '%s' => %s, want %s", tt.table, tt.match, name, tt.want)
+		}
+	}
+
+	// words only match as a whole
+	var count int
+	if err := db.QueryRow("SELECT count(*) FROM words WHERE words MATCH 'rule'").Scan(&count); err != nil {
+		t.Errorf("query failed: %v", err)
+	}
+
+	if count != 0 {
+		t.Errorf("words MATCH 'rule' => %d rows, want 0", count)
+	}
+}
+
+// compares an accent-insensitive substring search through LIKE (a full scan)
+// with the same search through a sqlean_unicode trigram fts5 index
+func BenchmarkSqleanUnicode_tokenizer(b *testing.B) {
+	if testing.Short() {
+		b.Skip("skipping million-row benchmark in short mode")
+	}
+
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+	SkipWithoutFts5(b, db)
+
+	if _, err := db.Exec("CREATE VIRTUAL TABLE search USING fts5(name, tokenize = 'sqlean_unicode trigram')"); err != nil {
+		b.Fatalf("failed to create table: %v", err)
+	}
+
+	for _, query := range []string{
+		`CREATE TABLE products AS
+			SELECT value AS id, 'Product ' || value || ' ' ||
+				CASE value % 5
+					WHEN 0 THEN 'Crème Brûlée'
+					WHEN 1 THEN 'Café au lait'
+					WHEN 2 THEN 'Smørrebrød'
+					WHEN 3 THEN 'Jalapeño poppers'
+					ELSE 'Crêpe Suzette'
+				END || ' ' || hex(randomblob(6)) AS name
+			FROM generate_series(1, 1000000)`,
+		"INSERT INTO search(rowid, name) SELECT id, name FROM products",
+	} {
+		if _, err := db.Exec(query); err != nil {
+			b.Fatalf("failed to populate tables: %v", err)
+		}
+	}
+
+	var run = func(query, arg string) func(b *testing.B) {
+		return func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				var count int
+				if err := db.QueryRow(query, arg).Scan(&count); err != nil {
+					b.Fatalf("query failed: %v", err)
+				}
+			}
+		}
+	}
+
+	b.ResetTimer()
+	b.Run("like", run("SELECT count(*) FROM products WHERE name LIKE ?", "%77775 creme brulee%"))
+	b.Run("fts5", run("SELECT count(*) FROM search WHERE search MATCH ?", `"77775 creme brulee"`))
+}
+
+func BenchmarkSqleanUnicode_nocaseIndex(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	const populate = `CREATE TABLE t AS
+		SELECT 'Customer ' || value || ' ' || hex(randomblob(12)) AS name FROM generate_series(1, 100000)`
+	if _, err := db.Exec(populate); err != nil {
+		b.Fatalf("failed to populate table: %v", err)
+	}
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := db.Exec("CREATE INDEX t_name ON t(name COLLATE NOCASE)"); err != nil {
+			b.Fatalf("failed to create index: %v", err)
+		}
+		if _, err := db.Exec("DROP INDEX t_name"); err != nil {
+			b.Fatalf("failed to drop index: %v", err)
+		}
+	}
+}
+
 func TestSqleanUuid_uuidv4(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -167,6 +937,230 @@ func TestSqleanUuid_uuidv4(t *testing.T) {
 	t.Logf("uuid() => %s", id)
 }
 
+func TestSqleanUuid_uuidv7(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	const query = `SELECT count(*), sum(prev >= id), sum(uuid7_timestamp(id) IS NULL) FROM (
+		SELECT id, lag(id) OVER (ORDER BY value) AS prev FROM (
+			SELECT uuid7() AS id, value FROM generate_series(1, 10000)))`
+	var count, unordered, untimed int
+	if err := db.QueryRow(query).Scan(&count, &unordered, &untimed); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if count != 10000 || unordered != 0 || untimed != 0 {
+		t.Errorf("uuid7() => %d uuids, %d out of order, %d without timestamp", count, unordered, untimed)
+	}
+
+	var version string
+	var blobTime, textTime int64
+	const convert = `SELECT substr(uuid_str(id), 15, 1), uuid7_timestamp(id), uuid7_timestamp(uuid_str(id))
+		FROM (SELECT uuid7_blob() AS id)`
+	if err := db.QueryRow(convert).Scan(&version, &blobTime, &textTime); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if version != "7" || blobTime != textTime {
+		t.Errorf("uuid7_blob() => version %s, timestamp %d != %d", version, blobTime, textTime)
+	}
+}
+
+func TestSqleanUuid_convert(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	const want = "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11"
+	var cases = []struct {
+		input string
+		valid bool
+	}{
+		{"'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'", true},
+		{"'A0EEBC99-9C0B-4EF8-BB6D-6BB9BD380A11'", true},
+		{"'{a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11}'", true},
+		{"'a0eebc999c0b4ef8bb6d6bb9bd380a11'", true},
+		{"'a0eebc99-9c0b4ef8-bb6d6bb9-bd380a11'", true},
+		{"X'a0eebc999c0b4ef8bb6d6bb9bd380a11'", true},
+		{"'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a1g'", false},
+		{"'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a1'", false},
+		{"'a0eebc99+9c0b-4ef8-bb6d-6bb9bd380a11'", false},
+		{"X'a0eebc999c0b4ef8bb6d6bb9bd380a'", false},
+	}
+	for _, c := range cases {
+		var str, blob sql.NullString
+		var query = fmt.Sprintf("SELECT uuid_str(%s), nullif(lower(hex(uuid_blob(%s))), '')", c.input, c.input)
+		if err := db.QueryRow(query).Scan(&str, &blob); err != nil {
+			t.Fatalf("%s: query failed: %v", c.input, err)
+		}
+		if !c.valid {
+			if str.Valid || blob.Valid {
+				t.Errorf("uuid_str(%s) => %v, uuid_blob(%s) => %v, expected NULL", c.input, str, c.input, blob)
+			}
+			continue
+		}
+		if str.String != want || blob.String != strings.ReplaceAll(want, "-", "") {
+			t.Errorf("uuid_str(%s) => %s, uuid_blob(%s) => %s", c.input, str.String, c.input, blob.String)
+		}
+	}
+}
+
+// converts uuids between text and blobs, which runs on every row read through the API
+func BenchmarkSqleanUuid_convert(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+	db.SetMaxOpenConns(1)
+
+	if _, err := db.Exec("CREATE TABLE t AS SELECT uuid7_blob() AS b, uuid7() AS s FROM generate_series(1, 10000)"); err != nil {
+		b.Fatalf("failed to create table: %v", err)
+	}
+	for _, query := range []string{"uuid_str(b)", "uuid_blob(s)"} {
+		b.Run(query[:strings.Index(query, "(")], func(b *testing.B) {
+			var count int
+			for i := 0; i < b.N; i++ {
+				if err := db.QueryRow(fmt.Sprintf("SELECT count(%s) FROM t", query)).Scan(&count); err != nil {
+					b.Fatalf("query failed: %v", err)
+				}
+			}
+		})
+	}
+}
+
+func TestSqleanUuid_series(t *testing.T) {
+	var db = Open(t, ":memory:")
+	defer db.Close()
+
+	var cases = []struct {
+		query   string
+		version string
+	}{
+		{"SELECT value FROM uuid_series(1000)", "4"},
+		{"SELECT value FROM uuid_series(1000, 4)", "4"},
+		{"SELECT value FROM uuid_series(1000, 7)", "7"},
+	}
+	for _, c := range cases {
+		var count, distinct, versioned, roundtrip int
+		var query = fmt.Sprintf(`SELECT count(*), count(DISTINCT value),
+			sum(substr(value, 15, 1) = '%s'), sum(uuid_str(uuid_blob(value)) = value) FROM (%s)`, c.version, c.query)
+		if err := db.QueryRow(query).Scan(&count, &distinct, &versioned, &roundtrip); err != nil {
+			t.Fatalf("%s: query failed: %v", c.query, err)
+		}
+		if count != 1000 || distinct != 1000 || versioned != 1000 || roundtrip != 1000 {
+			t.Errorf("%s => %d uuids, %d distinct, %d of version %s, %d round-trip",
+				c.query, count, distinct, versioned, c.version, roundtrip)
+		}
+	}
+
+	var unordered int
+	const ordered = `SELECT count(*) FROM (
+		SELECT value, lag(value) OVER (ORDER BY rowid) AS prev FROM uuid_series(10000, 7)) WHERE prev >= value`
+	if err := db.QueryRow(ordered).Scan(&unordered); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	if unordered != 0 {
+		t.Errorf("uuid_series(10000, 7) => %d out of order", unordered)
+	}
+
+	// max() keeps the largest value across rows, after the cursor has refilled its buffer
+	var largest, values string
+	if err := db.QueryRow("SELECT max(value), group_concat(value) FROM uuid_series(3000)").Scan(&largest, &values); err != nil {
+		t.Fatalf("query failed: %v", err)
+	}
+	var expected string
+	for _, value := range strings.Split(values, ",") {
+		if value > expected {
+			expected = value
+		}
+	}
+	if largest != expected {
+		t.Errorf("max(value) => %s, expected %s", largest, expected)
+	}
+
+	var empty int
+	if err := db.QueryRow("SELECT count(*) FROM uuid_series(0)").Scan(&empty); err != nil || empty != 0 {
+		t.Errorf("uuid_series(0) => %d, %v", empty, err)
+	}
+	if _, err := db.Exec("SELECT value FROM uuid_series(10, 5)"); err == nil {
+		t.Errorf("uuid_series(10, 5) expected error")
+	}
+}
+
+// generates uuids in bulk, uuid_series() fills and formats them in batches
+func BenchmarkSqleanUuid_series(b *testing.B) {
+	var db = Open(b, ":memory:")
+	defer db.Close()
+
+	var queries = []struct{ name, query string }{
+		{"uuid4", "SELECT count(uuid4()) FROM generate_series(1, 10000)"},
+		{"series4", "SELECT count(value) FROM uuid_series(10000)"},
+		{"uuid7", "SELECT count(uuid7()) FROM generate_series(1, 10000)"},
+		{"series7", "SELECT count(value) FROM uuid_series(10000, 7)"},
+	}
+	for _, q := range queries {
+		b.Run(q.name, func(b *testing.B) {
+			var count int
+			for i := 0; i < b.N; i++ {
+				if err := db.QueryRow(q.query).Scan(&count); err != nil {
+					b.Fatalf("query failed: %v", err)
+				}
+			}
+		})
+	}
+}
+
+// generates uuids on parallel connections, randomblob() takes the mutex of the SQLite PRNG
+// for every call, while uuid4() draws from the random pool of its connection
+func BenchmarkSqleanUuid_parallel(b *testing.B) {
+	var run = func(generator string) func(b *testing.B) {
+		return func(b *testing.B) {
+			var db = Open(b, ":memory:")
+			defer db.Close()
+			db.SetMaxIdleConns(32)
+
+			var query = fmt.Sprintf("SELECT count(%s) FROM generate_series(1, 1000)", generator)
+			b.SetParallelism(4)
+			b.ResetTimer()
+			b.RunParallel(func(pb *testing.PB) {
+				var count int
+				for pb.Next() {
+					if err := db.QueryRow(query).Scan(&count); err != nil {
+						b.Errorf("query failed: %v", err)
+						return
+					}
+				}
+			})
+		}
+	}
+
+	b.Run("randomblob", run("randomblob(16)"))
+	b.Run("uuid4", run("uuid4()"))
+	b.Run("uuid7", run("uuid7()"))
+}
+
+// compares the insert throughput of random (v4) and time-ordered (v7) keys in an index
+func BenchmarkSqleanUuid_insert(b *testing.B) {
+	var run = func(generator string) func(b *testing.B) {
+		return func(b *testing.B) {
+			var db = Open(b, b.TempDir()+"/uuid.db")
+			defer db.Close()
+			db.SetMaxOpenConns(1)
+
+			if _, err := db.Exec("CREATE TABLE t(id blob, value integer); CREATE INDEX t_id ON t(id)"); err != nil {
+				b.Fatalf("failed to create table: %v", err)
+			}
+
+			var insert = fmt.Sprintf("INSERT INTO t SELECT %s, value FROM generate_series(1, 1000)", generator)
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if _, err := db.Exec(insert); err != nil {
+					b.Fatalf("failed to insert: %v", err)
+				}
+			}
+		}
+	}
+
+	b.Run("uuid4", run("uuid_blob(uuid4())"))
+	b.Run("uuid7", run("uuid7_blob()"))
+}
+
 func TestSqlean_Version(t *testing.T) {
 	var db = Open(t, ":memory:")
 	defer db.Close()
@@ -12,31 +12,56 @@ import (
 	"net/http"
 	"os"
 	"path"
+	"path/filepath"
 	"regexp"
+	"sort"
 	"strings"
 	"time"
 )
 
 var (
 	version    string // version of sqlean to download
+	archive    string // path of a local source archive to use instead
 	headerFile string // name of the header file to write to
 	sourceFile string // name of the source file to write to
+	check      bool   // compare with the existing files instead of writing them
 )
 
 func init() {
 	flag.StringVar(&version, "version", "0.21.6", "version of sqlean to download")
+	flag.StringVar(&archive, "archive", "", "path of a local source archive (tar.gz) to use instead of downloading it")
 	flag.StringVar(&headerFile, "header", "sqlean.h", "name of the header file")
 	flag.StringVar(&sourceFile, "source", "sqlean.c", "name of the source file")
+	flag.BoolVar(&check, "check", false, "check that the existing files are what would be generated")
 }
 
 // extensions to be skipped
 var skip = []string{"src/regexp", "src/fuzzy"}
 
+// sections maintained in this repository carry one of these lines, and are copied over
+// from the existing files instead of being taken from the upstream release
+var local = regexp.MustCompile(`(?m)^// (Part of|Modified in) sqlean\.go\b`)
+
+// separates the header of a section from the code
+const separator = "// ---------------------------------"
+
 type File struct {
 	Path    string
 	Content []byte
 }
 
+// Section is the code of a file in the amalgamation
+type Section struct {
+	Path string
+	Body string // code up to the next section, as written to the amalgamation
+}
+
+// Block is a group of sections under a SQLEAN_ENABLE_* guard
+type Block struct {
+	Guard, End string
+	Sections   []*Section
+}
+
 // download tar.gz source archive from remote, open it and read its content into memory
 func download(src string) (_ []*File, err error) {
 	var resp *http.Response
@@ -49,7 +74,26 @@ func download(src string) (_ []*File, err error) {
 		return nil, fmt.Errorf("failed to fetch: server returned %d", resp.StatusCode)
 	}
 
-	var compressed, _ = gzip.NewReader(resp.Body)
+	return unpack(resp.Body)
+}
+
+// open tar.gz source archive from disk and read its content into memory
+func open(src string) (_ []*File, err error) {
+	var file *os.File
+	if file, err = os.Open(src); err != nil {
+		return nil, err
+	}
+	defer file.Close()
+
+	return unpack(file)
+}
+
+// read the files of tar.gz source archive into memory
+func unpack(r io.Reader) (_ []*File, err error) {
+	var compressed *gzip.Reader
+	if compressed, err = gzip.NewReader(r); err != nil {
+		return nil, err
+	}
 	var bundle = tar.NewReader(compressed)
 
 	var files []*File
@@ -115,6 +159,177 @@ func replace(buf []byte, pattern string) string {
 	return builder.String()
 }
 
+// splits the file into blocks of sections, the code outside of the blocks is not kept
+func parse(filename string, content []byte) (blocks []*Block, err error) {
+	var lines = strings.SplitAfter(string(content), "\n")
+	var line = func(i int) string { return strings.TrimSuffix(lines[i], "\n") }
+
+	var block *Block
+	var body *strings.Builder
+	var flush = func() {
+		if body != nil {
+			block.Sections[len(block.Sections)-1].Body = body.String()
+			body = nil
+		}
+	}
+	for i := 0; i < len(lines); i++ {
+		switch {
+		case block == nil:
+			if strings.HasPrefix(line(i), "#ifdef SQLEAN_ENABLE_") || strings.HasPrefix(line(i), "#if defined(SQLEAN_ENABLE_") {
+				block = &Block{Guard: line(i)}
+			}
+		case strings.HasPrefix(line(i), "#endif // SQLEAN_ENABLE_"):
+			flush()
+			block.End = line(i)
+			blocks = append(blocks, block)
+			block = nil
+		case line(i) == separator && i+2 < len(lines) && line(i+2) == separator:
+			flush()
+			block.Sections = append(block.Sections, &Section{Path: strings.TrimPrefix(line(i+1), "// ")})
+			body = &strings.Builder{}
+			i += 2
+		case body != nil:
+			body.WriteString(lines[i])
+		default:
+			return nil, fmt.Errorf("%s:%d: code outside of a section", filename, i+1)
+		}
+	}
+	if block != nil {
+		return nil, fmt.Errorf("%s: unterminated %s", filename, block.Guard)
+	}
+	return blocks, nil
+}
+
+// merges the upstream files into the blocks of the existing file. The blocks keep their order
+// and the sections maintained in this repository are kept as they are, while the other sections
+// are taken from the upstream release. New upstream files and extensions are added at the end.
+func merge(existing []*Block, files []*File) (blocks []*Block) {
+	var upstream = make(map[string]*File)
+	for _, file := range files {
+		upstream[file.Path] = file
+	}
+	var kept = make(map[string]bool)
+	for _, block := range existing {
+		for _, section := range block.Sections {
+			kept[section.Path] = kept[section.Path] || local.MatchString(section.Body)
+		}
+	}
+
+	var taken = make(map[string]bool)
+	var take = func(block *Block, file *File) {
+		var body = replace(file.Content, `#include\s+"[^"]+`) + "\n"
+		block.Sections = append(block.Sections, &Section{Path: file.Path, Body: body})
+		taken[file.Path] = true
+	}
+
+	// files of every extension, in the order of their paths
+	var groups = group(files, func(file *File) string { return strings.SplitN(file.Path, "/", 3)[1] })
+	for _, g := range groups {
+		sort.Slice(g, func(i, j int) bool { return g[i].Path < g[j].Path })
+	}
+	var rest = func(block *Block, name string) {
+		for _, file := range groups[name] {
+			if !taken[file.Path] && !kept[file.Path] {
+				take(block, file)
+			}
+		}
+		delete(groups, name)
+	}
+
+	for _, old := range existing {
+		var block = &Block{Guard: old.Guard, End: old.End}
+		for _, section := range old.Sections {
+			if kept[section.Path] {
+				block.Sections = append(block.Sections, section)
+			} else if file, ok := upstream[section.Path]; ok {
+				take(block, file)
+			}
+		}
+		if name := strings.ToLower(strings.TrimPrefix(old.Guard, "#ifdef SQLEAN_ENABLE_")); groups[name] != nil {
+			rest(block, name)
+		}
+		if len(block.Sections) > 0 {
+			blocks = append(blocks, block)
+		}
+	}
+
+	var names []string
+	for name := range groups {
+		names = append(names, name)
+	}
+	sort.Strings(names)
+	for _, name := range names {
+		var block = &Block{
+			Guard: sp("#ifdef SQLEAN_ENABLE_%s", strings.ToUpper(name)),
+			End:   sp("#endif // SQLEAN_ENABLE_%s", strings.ToUpper(name)),
+		}
+		rest(block, name)
+		blocks = append(blocks, block)
+	}
+	return blocks
+}
+
+// writes the blocks to the given writer
+func emit(w io.Writer, blocks []*Block) {
+	for _, block := range blocks {
+		write(w, block.Guard)
+		for _, section := range block.Sections {
+			write(w, separator)
+			write(w, sp("// %s", section.Path))
+			write(w, separator)
+			_, _ = io.WriteString(w, section.Body)
+		}
+		write(w, block.End)
+	}
+}
+
+// the generation time is not compared by -check
+var timestamp = regexp.MustCompile(`(?m)^#define SQLEAN_GENERATE_TIMESTAMP .*$`)
+
+// writes the generated file, or with -check, compares it with the existing one and
+// returns false if they differ
+func output(filename string, content []byte, generated []byte) bool {
+	if !check {
+		if err := os.WriteFile(filename, generated, 0666); err != nil {
+			log.Fatalf("failed to write to %s: %v", filename, err)
+		}
+		return true
+	}
+
+	if timestamp.ReplaceAllString(string(content), "") == timestamp.ReplaceAllString(string(generated), "") {
+		return true
+	}
+
+	// point out the sections that regenerating would change
+	var existing, _ = parse(filename, content)
+	var sections = make(map[string]string)
+	for _, block := range existing {
+		for _, section := range block.Sections {
+			sections[section.Path] = section.Body
+		}
+	}
+	log.Printf("%s differs from the generated file", filename)
+	var file = filepath.Join(os.TempDir(), "sqlean-check-"+filepath.Base(filename))
+	if err := os.WriteFile(file, generated, 0666); err == nil {
+		log.Printf("  generated file written to %s", file)
+	}
+	var blocks, _ = parse(filename, generated)
+	for _, block := range blocks {
+		for _, section := range block.Sections {
+			if body, ok := sections[section.Path]; !ok {
+				log.Printf("  %s: added", section.Path)
+			} else if body != section.Body {
+				log.Printf("  %s: changed", section.Path)
+			}
+			delete(sections, section.Path)
+		}
+	}
+	for path := range sections {
+		log.Printf("  %s: removed", path)
+	}
+	return false
+}
+
 // writes preamble to the given writer
 func preamble(w io.Writer) {
 	write(w, "// ---------------------------------")
@@ -132,7 +347,11 @@ func main() {
 	var err error
 
 	var files []*File
-	if files, err = download(src); err != nil {
+	if archive != "" {
+		if files, err = open(archive); err != nil {
+			log.Fatalf("failed to open %q: %v", archive, err)
+		}
+	} else if files, err = download(src); err != nil {
 		log.Fatalf("failed to download %q: %v", src, err)
 	}
 
@@ -158,6 +377,23 @@ func main() {
 		return true
 	})
 
+	// the existing files, to carry over the sections maintained in this repository
+	var existingHeader, existingSource []byte
+	var headerBlocks, sourceBlocks []*Block
+	for _, f := range []struct {
+		name    string
+		content *[]byte
+		blocks  *[]*Block
+	}{{headerFile, &existingHeader, &headerBlocks}, {sourceFile, &existingSource, &sourceBlocks}} {
+		if *f.content, err = os.ReadFile(f.name); err != nil && !os.IsNotExist(err) {
+			log.Fatalf("failed to read %s: %v", f.name, err)
+		}
+		if *f.blocks, err = parse(f.name, *f.content); err != nil {
+			log.Fatalf("failed to parse %s: %v", f.name, err)
+		}
+	}
+	var same = true
+
 	var headers = filter(files, func(file *File) bool { return strings.HasSuffix(file.Path, ".h") })
 	{ // write sqlean.h header file
 		var buf bytes.Buffer
@@ -183,17 +419,7 @@ func main() {
 		write(&buf, sp("#define SQLEAN_GENERATE_TIMESTAMP %q", time.Now().Format(time.RFC3339)))
 		writeln(&buf)
 
-		var g = group(headers, func(file *File) string { return strings.SplitN(file.Path, "/", 3)[1] })
-		for name, hdrs := range g {
-			write(&buf, sp("#ifdef SQLEAN_ENABLE_%s", strings.ToUpper(name)))
-			for _, hdr := range hdrs {
-				write(&buf, "// ---------------------------------")
-				write(&buf, sp("// %s", hdr.Path))
-				write(&buf, "// ---------------------------------")
-				write(&buf, replace(hdr.Content, `#include\s+"[^"]+`))
-			}
-			write(&buf, sp("#endif // SQLEAN_ENABLE_%s", strings.ToUpper(name)))
-		}
+		emit(&buf, merge(headerBlocks, headers))
 
 		writeln(&buf)
 		write(&buf, "// add sqlean_version() sql function that returns the current version of sqlean")
@@ -207,9 +433,7 @@ func main() {
 		writeln(&buf)
 		write(&buf, "#endif  // SQLEAN_H")
 
-		if err = os.WriteFile(headerFile, buf.Bytes(), 0666); err != nil {
-			log.Fatalf("failed to write to %s: %v", headerFile, err)
-		}
+		same = output(headerFile, existingHeader, buf.Bytes()) && same
 	}
 
 	var sources = filter(files, func(file *File) bool { return strings.HasSuffix(file.Path, ".c") })
@@ -227,19 +451,7 @@ func main() {
 		write(&buf, "#endif")
 		writeln(&buf)
 
-		var g = group(sources, func(file *File) string { return strings.SplitN(file.Path, "/", 3)[1] })
-		for name, srcs := range g {
-			write(&buf, sp("#ifdef SQLEAN_ENABLE_%s", strings.ToUpper(name)))
-
-			for _, s := range srcs {
-				write(&buf, "// ---------------------------------")
-				write(&buf, sp("// %s", s.Path))
-				write(&buf, "// ---------------------------------")
-				write(&buf, replace(s.Content, `#include\s+"[^"]+`))
-			}
-
-			write(&buf, sp("#endif // SQLEAN_ENABLE_%s", strings.ToUpper(name)))
-		}
+		emit(&buf, merge(sourceBlocks, sources))
 
 		writeln(&buf)
 		write(&buf, "// add sqlean_version() sql function that returns the current version of sqlean")
@@ -252,8 +464,10 @@ func main() {
 		write(&buf, "}")
 		write(&buf, "#endif")
 
-		if err = os.WriteFile(sourceFile, buf.Bytes(), 0666); err != nil {
-			log.Fatalf("failed to write to %s: %v", sources, err)
-		}
+		same = output(sourceFile, existingSource, buf.Bytes()) && same
+	}
+
+	if !same {
+		log.Fatalf("the amalgamation is out of date, or has changes outside of the sections maintained in this repository")
 	}
 }
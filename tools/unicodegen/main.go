@@ -0,0 +1,158 @@
+package main
+
+import (
+	"bytes"
+	"flag"
+	"fmt"
+	"io"
+	"log"
+	"os"
+	"strings"
+	"unicode"
+)
+
+// unicodegen generates the case mapping tables of the unicode extension from the
+// tables in go's unicode package, and writes them into the amalgamation source file.
+//
+// Every mapping is stored as a two-stage table. The first stage maps a block of
+// 1 << shift code points to a block index, and the second stage holds the difference
+// between the mapped and the original code point for every code point in the block.
+// Code points at or above the table limit map to themselves.
+//
+//	go run ./tools/unicodegen --source sqlean.c
+
+var (
+	sourceFile string // name of the source file to write to
+	shift      uint   // number of bits addressed by the second stage
+)
+
+func init() {
+	flag.StringVar(&sourceFile, "source", "sqlean.c", "name of the source file")
+	flag.UintVar(&shift, "shift", 5, "block size (as a power of 2) of the second stage tables")
+}
+
+const (
+	startMarker = "/* Generated by tools/unicodegen. Do not modify. Start unicode_case_tables */"
+	endMarker   = "/* Generated by tools/unicodegen. Do not modify. End unicode_case_tables */"
+)
+
+// fold returns the simple case folding (CaseFolding.txt status C + S) of r
+func fold(r rune) rune {
+	switch {
+	case r == 0x0130 || r == 0x0131:
+		return r // dotted / dotless i only have the turkic (T) and full (F) foldings
+	case unicode.Is(unicode.Cherokee, r):
+		return unicode.ToUpper(r) // cherokee folds to the upper case letters
+	}
+	return unicode.ToLower(unicode.ToUpper(r))
+}
+
+type Mapping struct {
+	Name  string          // name of the mapping, used in table names
+	Guard string          // the preprocessor definition the tables are compiled under
+	Fn    func(rune) rune // function that maps a single code point
+}
+
+var mappings = []Mapping{
+	{Name: "fold", Guard: "SQLITE3_UNICODE_FOLD", Fn: fold},
+	{Name: "lower", Guard: "SQLITE3_UNICODE_LOWER", Fn: unicode.ToLower},
+	{Name: "upper", Guard: "SQLITE3_UNICODE_UPPER", Fn: unicode.ToUpper},
+	{Name: "title", Guard: "SQLITE3_UNICODE_TITLE", Fn: unicode.ToTitle},
+}
+
+func write(w io.Writer, format string, args ...interface{}) { _, _ = fmt.Fprintf(w, format, args...) }
+
+// generate writes the two-stage tables for mapping m into w
+func generate(w io.Writer, m Mapping) {
+	var size = rune(1) << shift
+
+	// limit is the first code point past the last block that changes anything
+	var limit rune
+	for r := rune(0); r <= unicode.MaxRune; r++ {
+		if m.Fn(r) != r {
+			limit = (r | (size - 1)) + 1
+		}
+	}
+
+	var stage1 []int
+	var stage2 [][]rune
+	var seen = make(map[string]int)
+	for block := rune(0); block < limit; block += size {
+		var deltas = make([]rune, size)
+		for i := range deltas {
+			deltas[i] = m.Fn(block+rune(i)) - (block + rune(i))
+		}
+
+		var key = fmt.Sprint(deltas)
+		if _, ok := seen[key]; !ok {
+			seen[key] = len(stage2)
+			stage2 = append(stage2, deltas)
+		}
+		stage1 = append(stage1, seen[key])
+	}
+
+	if len(stage2) > 256 {
+		log.Fatalf("%s: %d blocks do not fit into an unsigned char index, use a larger shift", m.Name, len(stage2))
+	}
+
+	var upper = strings.ToUpper(m.Name)
+	write(w, "#ifdef %s\n", m.Guard)
+	write(w, "#define UNICODE_%s_LIMIT 0x%X\n", upper, limit)
+	write(w, "#define UNICODE_%s_BLOCK_COUNT %d\n\n", upper, len(stage2))
+
+	write(w, "static const unsigned char unicode_%s_blocks[UNICODE_%s_LIMIT >> UNICODE_CASE_BLOCK_SHIFT] = {", m.Name, upper)
+	for i, index := range stage1 {
+		if i%24 == 0 {
+			write(w, "\n   ")
+		}
+		write(w, " %d,", index)
+	}
+	write(w, "};\n\n")
+
+	write(w, "static const int unicode_%s_deltas[UNICODE_%s_BLOCK_COUNT][UNICODE_CASE_BLOCK_SIZE] = {\n", m.Name, upper)
+	for _, deltas := range stage2 {
+		write(w, "    {")
+		for i, delta := range deltas {
+			switch {
+			case i == 0:
+			case i%16 == 0:
+				write(w, ",\n     ")
+			default:
+				write(w, ", ")
+			}
+			write(w, "%d", delta)
+		}
+		write(w, "},\n")
+	}
+	write(w, "};\n")
+	write(w, "#endif\n\n")
+}
+
+func main() {
+	flag.Parse()
+
+	var source, err = os.ReadFile(sourceFile)
+	if err != nil {
+		log.Fatalf("failed to read source: %v", err)
+	}
+
+	var start, end = bytes.Index(source, []byte(startMarker)), bytes.Index(source, []byte(endMarker))
+	if start < 0 || end < start {
+		log.Fatalf("failed to find the %q markers in %s", "unicode_case_tables", sourceFile)
+	}
+
+	var buf bytes.Buffer
+	write(&buf, "%s\n", startMarker)
+	write(&buf, "/* Unicode %s */\n", unicode.Version)
+	write(&buf, "#define UNICODE_CASE_BLOCK_SHIFT %d\n", shift)
+	write(&buf, "#define UNICODE_CASE_BLOCK_SIZE (1 << UNICODE_CASE_BLOCK_SHIFT)\n")
+	write(&buf, "#define UNICODE_CASE_BLOCK_MASK (UNICODE_CASE_BLOCK_SIZE - 1)\n\n")
+	for _, m := range mappings {
+		generate(&buf, m)
+	}
+
+	var out = append(append(append([]byte{}, source[:start]...), buf.Bytes()...), source[end:]...)
+	if err = os.WriteFile(sourceFile, out, 0644); err != nil {
+		log.Fatalf("failed to write source: %v", err)
+	}
+}